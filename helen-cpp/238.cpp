@@ -5,7 +5,13 @@
 #include <map>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <ctime>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <utility>
 
 struct StateData {
 
@@ -244,8 +250,167 @@ void print_results(const std::map<std::string, StateData>& state_map) {
 
 }
 
-// calculate alpha using random sampling - FAST approximation
-float calculate_alpha_sampling(const std::map<std::string, StateData>& state_map, int total_seats) {
+// streaming summary of every alpha seen by the sampler. cheap to update per sample and
+// mergeable, so each thread keeps its own and they are combined at the end
+struct AlphaSketch {
+
+    static constexpr int NUM_BINS = 400; // fixed-width bins over [0, ALPHA_MAX), plus one overflow bin
+    static constexpr float ALPHA_MAX = 2.0;
+    static constexpr int TOP_K = 100; // number of worst coalitions to keep
+
+    std::vector<long long> bins;
+    long long count;
+    std::vector<std::pair<float, long long>> worst; // (alpha, mask), max-heap on alpha so front is the best of the worst
+
+    AlphaSketch() : bins(NUM_BINS + 1, 0), count(0) {}
+
+    void add(float alpha, long long mask) {
+
+        int bin = (int)(alpha / ALPHA_MAX * NUM_BINS);
+        bins[std::min(std::max(bin, 0), NUM_BINS)]++;
+        count++;
+
+        add_worst(alpha, mask);
+
+    }
+
+    void add_worst(float alpha, long long mask) {
+
+        if ((int)worst.size() == TOP_K && alpha >= worst.front().first) // not among the worst, the common case
+            return;
+
+        for (const auto& [a, m] : worst) { // small coalitions get drawn many times, keep each mask once
+            if (m == mask)
+                return;
+        }
+
+        if ((int)worst.size() == TOP_K) {
+            std::pop_heap(worst.begin(), worst.end());
+            worst.pop_back();
+        }
+
+        worst.push_back({alpha, mask});
+        std::push_heap(worst.begin(), worst.end());
+
+    }
+
+    void merge(const AlphaSketch& other) {
+
+        for (int i = 0; i <= NUM_BINS; i++)
+            bins[i] += other.bins[i];
+
+        count += other.count;
+
+        for (const auto& [alpha, mask] : other.worst)
+            add_worst(alpha, mask);
+
+    }
+
+    // approximate quantile, accurate to one bin width. NaN if nothing has been added
+    float quantile(float q) const {
+
+        if (count == 0)
+            return NAN;
+
+        long long target = (long long)(q * count);
+        long long seen = 0;
+
+        for (int i = 0; i <= NUM_BINS; i++) {
+
+            seen += bins[i];
+
+            if (seen > target)
+                return (i + 0.5f) * ALPHA_MAX / NUM_BINS;
+
+        }
+
+        return ALPHA_MAX;
+
+    }
+
+    // worst coalitions sorted from lowest alpha up
+    std::vector<std::pair<float, long long>> sorted_worst() const {
+
+        std::vector<std::pair<float, long long>> sorted = worst;
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
+
+    }
+
+};
+
+// write histogram, worst coalitions and per-state counts among the worst coalitions as csv
+void write_alpha_sketch(const AlphaSketch& sketch, const std::map<std::string, StateData>& state_map, const std::string& filename) {
+
+    if (sketch.count == 0) { // e.g. threshold 1, where every sampled subset is the full set
+
+        std::cout << "no alphas sampled, not writing " << filename << std::endl;
+        return;
+
+    }
+
+    std::ofstream file(filename);
+
+    if (!file.is_open()) {
+
+        std::cerr << "error: could not open file " << filename << std::endl;
+        return;
+
+    }
+
+    std::vector<std::string> states;
+
+    for (const auto& [state, data] : state_map)
+        states.push_back(state);
+
+    int n = states.size();
+
+    file << "kind,key,value\n";
+    file << "count,," << sketch.count << "\n";
+
+    for (int i = 0; i < AlphaSketch::NUM_BINS; i++) {
+
+        if (sketch.bins[i] > 0)
+            file << "bin," << (float)i * AlphaSketch::ALPHA_MAX / AlphaSketch::NUM_BINS << "," << sketch.bins[i] << "\n";
+
+    }
+
+    if (sketch.bins[AlphaSketch::NUM_BINS] > 0)
+        file << "bin," << AlphaSketch::ALPHA_MAX << "," << sketch.bins[AlphaSketch::NUM_BINS] << "\n";
+
+    std::vector<int> state_counts(n, 0);
+
+    for (const auto& [alpha, mask] : sketch.sorted_worst()) {
+
+        file << "worst," << alpha << ",";
+
+        bool first = true;
+
+        for (int i = 0; i < n; i++) {
+
+            if (mask & (1LL << i)) {
+
+                file << (first ? "" : " ") << states[i];
+                state_counts[i]++;
+                first = false;
+
+            }
+        }
+
+        file << "\n";
+
+    }
+
+    for (int i = 0; i < n; i++)
+        file << "state," << states[i] << "," << state_counts[i] << "\n";
+
+    file.close();
+
+}
+
+// calculate alpha using random sampling with (threshold) amount included, merging every sampled alpha into (sketch). samples are split across threads,
+// each with its own generator and sketch
+float calculate_alpha_sampling(const std::map<std::string, StateData>& state_map, int total_seats, float threshold, AlphaSketch& sketch) {
     
     std::vector<std::string> states;
     std::vector<int> state_pops;
@@ -261,78 +426,120 @@ float calculate_alpha_sampling(const std::map<std::string, StateData>& state_map
     
     int n = states.size();
     long long num_samples = 100000000; // number of samples
+    int num_threads = std::max(1u, std::thread::hardware_concurrency());
     
     int total_pop = get_total_population(state_map);
-    float min_alpha = 1.0;
-    long long worst_mask = 0; // store mask instead of subset vector
-    float worst_pop_prop = 0;
-    float worst_seat_prop = 0;
+    uint32_t include_below = (uint32_t)std::min(threshold * 4294967296.0, 4294967295.0); // we want (threshold) amount to be included
     
-    std::cout << "sampling " << num_samples << " random subsets out of " 
-              << ((1LL << n) - 2) << " total..." << std::endl;
+    std::cout << "sampling " << num_samples << " random subsets with threshold " << threshold << " out of " 
+              << ((1LL << n) - 2) << " total samples on " << num_threads << " threads..." << std::endl;
     
-    // seed random number generator
-    std::srand(std::time(nullptr));
+    std::vector<AlphaSketch> thread_sketches(num_threads);
+    std::vector<std::thread> threads;
+    std::random_device seed;
     
-    for (long long sample = 0; sample < num_samples; sample++) {
-        
-        // generate random subset mask
-        long long mask = 0;
-        for (int i = 0; i < n; i++) {
-            if (std::rand() % 2 == 1) { // 50% chance to include each state
-                mask |= (1LL << i);
-            }
-        }
-        
-        if (mask == 0 || mask == (1LL << n) - 1) // skip empty and full set
-            continue;
+    for (int t = 0; t < num_threads; t++) {
         
-        int subset_pop = 0;
-        int subset_seats = 0;
+        long long thread_samples = num_samples / num_threads + (t < num_samples % num_threads ? 1 : 0);
+        unsigned int thread_seed = seed() ^ (unsigned int)std::time(nullptr) ^ (unsigned int)t;
         
-        for (int i = 0; i < n; i++) { // fast lookup using arrays instead of map
+        threads.emplace_back([&, t, thread_samples, thread_seed]() {
             
-            if (mask & (1LL << i)) {
-                
-                subset_pop += state_pops[i];
-                subset_seats += state_seats[i];
+            std::mt19937 rng(thread_seed);
+            AlphaSketch local; // on this thread's stack, so the per-sample writes never share a cache line with another thread
             
+            for (long long sample = 0; sample < thread_samples; sample++) {
+                
+                // generate random subset mask
+                long long mask = 0;
+                for (int i = 0; i < n; i++) {
+                    if (rng() < include_below) {
+                        mask |= (1LL << i);
+                    }
+                }
+                
+                if (mask == 0 || mask == (1LL << n) - 1) // skip empty and full set
+                    continue;
+                
+                int subset_pop = 0;
+                int subset_seats = 0;
+                
+                for (int i = 0; i < n; i++) { // fast lookup using arrays instead of map
+                    
+                    if (mask & (1LL << i)) {
+                        
+                        subset_pop += state_pops[i];
+                        subset_seats += state_seats[i];
+                    
+                    }
+                }
+                
+                float pop_proportion = (float)subset_pop / total_pop;
+                float seat_proportion = (float)subset_seats / total_seats;
+                
+                if (pop_proportion > 0.0001)
+                    local.add(seat_proportion / pop_proportion, mask);
+                
+                if (t == 0 && sample % (thread_samples / 10) == 0 && sample > 0) { // first thread reports for everyone
+                    std::cout << "checked ~" << sample * num_threads << " / " << num_samples << " samples (" 
+                              << (100.0 * sample / thread_samples) << "%)..." << std::endl;
+                }
             }
-        }
+            
+            thread_sketches[t] = std::move(local);
+        });
+    }
+    
+    AlphaSketch pass; // this pass only, so the printed minimum is not affected by earlier merges into (sketch)
+    
+    for (int t = 0; t < num_threads; t++) {
         
-        float pop_proportion = (float)subset_pop / total_pop;
-        float seat_proportion = (float)subset_seats / total_seats;
+        threads[t].join();
+        pass.merge(thread_sketches[t]);
+    
+    }
+    
+    sketch.merge(pass);
+    
+    float min_alpha = 1.0;
+    long long worst_mask = 0;
+    
+    for (const auto& [alpha, mask] : pass.worst) {
         
-        if (pop_proportion > 0.0001) {
-            
-            float alpha = seat_proportion / pop_proportion;
-            
-            if (alpha < min_alpha) {
-                
-                min_alpha = alpha;
-                worst_mask = mask; // just store the mask
-                worst_pop_prop = pop_proportion;
-                worst_seat_prop = seat_proportion;
+        if (alpha < min_alpha) {
             
-            }
-        }
+            min_alpha = alpha;
+            worst_mask = mask;
         
-        if (sample % (num_samples / 10) == 0 && sample > 0) {
-            std::cout << "checked " << sample << " / " << num_samples << " samples (" 
-                      << (100.0 * sample / num_samples) << "%)..." << std::endl;
         }
     }
     
     std::vector<std::string> worst_subset; // reconstruct worst subset at the end
+    int worst_pop = 0;
+    int worst_seats = 0;
     
     for (int i = 0; i < n; i++) {
         
-        if (worst_mask & (1LL << i)) 
+        if (worst_mask & (1LL << i)) {
+            
             worst_subset.push_back(states[i]);
-    
+            worst_pop += state_pops[i];
+            worst_seats += state_seats[i];
+        
+        }
     }
     
+    float worst_pop_prop = (float)worst_pop / total_pop;
+    float worst_seat_prop = (float)worst_seats / total_seats;
+    
     std::cout << "\n[APPROXIMATE] alpha >= " << min_alpha << " (based on " << num_samples << " samples)" << std::endl;
+    
+    if (pass.count > 0)
+        std::cout << "alpha quantiles: p1 " << pass.quantile(0.01) << ", p50 " << pass.quantile(0.5) 
+                  << ", p99 " << pass.quantile(0.99) << std::endl;
+    else
+        std::cout << "no alphas sampled, every subset was empty, full or too small" << std::endl;
+    
     std::cout << "\nworst subset found (" << worst_subset.size() << " states):" << std::endl;
     
     for (const std::string& state : worst_subset) 
@@ -348,107 +555,520 @@ float calculate_alpha_sampling(const std::map<std::string, StateData>& state_map
 
 // calculate alpha using random sampling - FAST approximation. uses (threshold) amount instead of purely random sampling
 float calculate_alpha_sampling(const std::map<std::string, StateData>& state_map, int total_seats, float threshold) {
-    
+
+    AlphaSketch sketch;
+    return calculate_alpha_sampling(state_map, total_seats, threshold, sketch);
+
+}
+
+// calculate alpha using random sampling - FAST approximation
+float calculate_alpha_sampling(const std::map<std::string, StateData>& state_map, int total_seats) {
+
+    return calculate_alpha_sampling(state_map, total_seats, 0.5); // 50% chance to include each state
+
+}
+
+// one paradox found by the scanner, with a readable witness
+struct Paradox {
+
+    std::string method;
+    std::string kind; // quota, alabama or population
+    std::string census;
+    int house_size;
+    std::string witness;
+
+};
+
+// populations of the states present in both maps, in the same order, so allocations can be compared index by index
+struct CensusPair {
+
     std::vector<std::string> states;
-    std::vector<int> state_pops;
-    std::vector<int> state_seats;
-    
-    for (const auto& [state, data] : state_map) { // pre-compute arrays for faster lookup
-        
-        states.push_back(state);
-        state_pops.push_back(data.population);
-        state_seats.push_back(data.seats);
-    
+    std::vector<long long> old_pops;
+    std::vector<long long> new_pops;
+
+};
+
+CensusPair match_censuses(const std::map<std::string, StateData>& old_map, const std::map<std::string, StateData>& new_map) {
+
+    CensusPair pair;
+
+    for (const auto& [state, data] : old_map) {
+
+        auto it = new_map.find(state);
+
+        if (it == new_map.end())
+            continue;
+
+        pair.states.push_back(state);
+        pair.old_pops.push_back(data.population);
+        pair.new_pops.push_back(it->second.population);
+
     }
-    
-    int n = states.size();
-    long long num_samples = 100000000; // number of samples
-    
-    int total_pop = get_total_population(state_map);
-    float min_alpha = 1.0;
-    long long worst_mask = 0; // store mask instead of subset vector
-    float worst_pop_prop = 0;
-    float worst_seat_prop = 0;
-    
-    std::cout << "sampling " << num_samples << " random subsets with threshold " << threshold << " out of " 
-              << ((1LL << n) - 2) << " total samples..." << std::endl;
-    
-    // seed random number generator
-    std::srand(std::time(nullptr));
-    
-    for (long long sample = 0; sample < num_samples; sample++) {
-        
-        // generate random subset mask
-        long long mask = 0;
-        for (int i = 0; i < n; i++) {
-            if (std::rand() > (1 - threshold) * RAND_MAX) { // we want (threshold) amount to be included
-                mask |= (1LL << i);
-            }
+
+    return pair;
+
+}
+
+// divisor d(seats) used to rank states for their next seat. jefferson, webster, adams and huntington-hill
+// are all "give the next seat to the largest population / d(seats)", which is what lets the scanner reuse
+// the allocation for K when moving to K + 1
+double seat_divisor(const std::string& method, int seats) {
+
+    if (method == "jefferson")
+        return seats + 1.0;
+
+    if (method == "webster")
+        return seats + 0.5;
+
+    if (method == "adams")
+        return seats;
+
+    return sqrt(seats * (seats + 1.0)); // huntington_hill
+
+}
+
+// smallest house a divisor method can produce. adams and huntington-hill give every state a seat up front
+int divisor_base_seats(const std::string& method) {
+
+    return (method == "adams" || method == "huntington_hill") ? 1 : 0;
+
+}
+
+// divisor methods: give one more seat to the state with the highest priority
+void divisor_add_seat(const std::string& method, const std::vector<long long>& pops, std::vector<int>& seats) {
+
+    int best = 0;
+    double max_priority = -1;
+
+    for (int i = 0; i < (int)pops.size(); i++) {
+
+        double priority = pops[i] / seat_divisor(method, seats[i]);
+
+        if (priority > max_priority) {
+
+            max_priority = priority;
+            best = i;
+
         }
-        
-        if (mask == 0 || mask == (1LL << n) - 1) // skip empty and full set
-            continue;
-        
-        int subset_pop = 0;
-        int subset_seats = 0;
-        
-        for (int i = 0; i < n; i++) { // fast lookup using arrays instead of map
-            
-            if (mask & (1LL << i)) {
-                
-                subset_pop += state_pops[i];
-                subset_seats += state_seats[i];
-            
-            }
+    }
+
+    seats[best]++;
+
+}
+
+// seats a state gets under a divisor method when every seat with priority above (cutoff) is handed out,
+// capped at (limit) since anything past the house size only matters as "too many"
+int divisor_seats_above(const std::string& method, long long pop, double cutoff, int limit) {
+
+    int base = divisor_base_seats(method);
+    int seats = std::min(std::max((int)std::min(pop / cutoff, (double)limit), base), limit); // d(seats) is within a seat of seats
+
+    while (seats > base && pop / seat_divisor(method, seats - 1) <= cutoff)
+        seats--;
+
+    while (seats < limit && pop / seat_divisor(method, seats) > cutoff)
+        seats++;
+
+    return seats;
+
+}
+
+// divisor methods for a whole house at once: bisect for a divisor that hands out at most (total_seats),
+// then give out the seats lost to ties one at a time. same seats as adding them one by one from the base
+std::vector<int> divisor_seats(const std::string& method, const std::vector<long long>& pops, int total_seats) {
+
+    int n = pops.size();
+    double lo = 0; // hands out too many seats
+    double hi = 0; // hands out at most total_seats
+
+    for (long long pop : pops)
+        hi = std::max(hi, pop / seat_divisor(method, divisor_base_seats(method)));
+
+    for (int iter = 0; iter < 100; iter++) {
+
+        double mid = (lo + hi) / 2;
+        long long seats_assigned = 0;
+
+        for (int i = 0; i < n && seats_assigned <= total_seats; i++)
+            seats_assigned += divisor_seats_above(method, pops[i], mid, total_seats + 1);
+
+        if (seats_assigned <= total_seats)
+            hi = mid;
+        else
+            lo = mid;
+
+    }
+
+    std::vector<int> seats(n);
+    int seats_assigned = 0;
+
+    for (int i = 0; i < n; i++) {
+
+        seats[i] = divisor_seats_above(method, pops[i], hi, total_seats + 1);
+        seats_assigned += seats[i];
+
+    }
+
+    for (; seats_assigned < total_seats; seats_assigned++)
+        divisor_add_seat(method, pops, seats);
+
+    return seats;
+
+}
+
+// hamilton's method in exact integer arithmetic. quota of state i is pops[i] * K / total_pop, so the
+// remainders compare as pops[i] * K % total_pop without float rounding deciding close calls
+std::vector<int> hamilton_seats(const std::vector<long long>& pops, long long total_pop, int total_seats) {
+
+    int n = pops.size();
+    std::vector<int> seats(n);
+    std::vector<int> order(n);
+    int seats_assigned = 0;
+
+    for (int i = 0; i < n; i++) {
+
+        seats[i] = pops[i] * total_seats / total_pop;
+        seats_assigned += seats[i];
+        order[i] = i;
+
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return pops[a] * total_seats % total_pop > pops[b] * total_seats % total_pop;
+    });
+
+    for (int i = 0; seats_assigned < total_seats; i++, seats_assigned++)
+        seats[order[i]]++;
+
+    return seats;
+
+}
+
+// walks K = first..last for one method and one population vector, keeping the allocation for K - 1 around
+class AllocationWalker {
+
+public:
+
+    AllocationWalker(const std::string& method, const std::vector<long long>& pops, int first_house)
+        : method(method), pops(pops), total_pop(0), house(0) {
+
+        for (long long pop : pops)
+            total_pop += pop;
+
+        if (method == "hamilton") {
+
+            house = first_house;
+            seats = hamilton_seats(pops, total_pop, house);
+            return;
+
         }
-        
-        float pop_proportion = (float)subset_pop / total_pop;
-        float seat_proportion = (float)subset_seats / total_seats;
-        
-        if (pop_proportion > 0.0001) {
-            
-            float alpha = seat_proportion / pop_proportion;
-            
-            if (alpha < min_alpha) {
-                
-                min_alpha = alpha;
-                worst_mask = mask; // just store the mask
-                worst_pop_prop = pop_proportion;
-                worst_seat_prop = seat_proportion;
-            
-            }
+
+        house = std::max(first_house, divisor_base_seats(method) * (int)pops.size());
+        seats = divisor_seats(method, pops, house); // seed the chunk from a divisor, then walk seat by seat
+    }
+
+    void next() {
+
+        house++;
+
+        if (method == "hamilton")
+            seats = hamilton_seats(pops, total_pop, house);
+        else
+            divisor_add_seat(method, pops, seats); // house monotone, so K + 1 only adds one seat to K
+
+    }
+
+    const std::vector<int>& get_seats() const { return seats; }
+    long long get_total_pop() const { return total_pop; }
+
+private:
+
+    std::string method;
+    const std::vector<long long>& pops;
+    long long total_pop;
+    int house;
+    std::vector<int> seats;
+
+};
+
+void check_quota(const std::string& method, const std::string& census, int total_seats, const std::vector<std::string>& states,
+                 const std::vector<long long>& pops, long long total_pop, const std::vector<int>& seats, std::vector<Paradox>& found) {
+
+    for (int i = 0; i < (int)states.size(); i++) {
+
+        long long lower = pops[i] * total_seats / total_pop;
+        long long upper = lower + (pops[i] * total_seats % total_pop != 0 ? 1 : 0);
+
+        if (seats[i] < lower || seats[i] > upper) {
+
+            std::ostringstream witness;
+            witness << states[i] << " gets " << seats[i] << " seats outside quota [" << lower << ".." << upper << "]";
+            found.push_back({method, "quota", census, total_seats, witness.str()});
+
         }
-        
-        if (sample % (num_samples / 10) == 0 && sample > 0) {
-            std::cout << "checked " << sample << " / " << num_samples << " samples (" 
-                      << (100.0 * sample / num_samples) << "%)..." << std::endl;
+    }
+}
+
+void check_alabama(const std::string& method, const std::string& census, int total_seats, const std::vector<std::string>& states,
+                   const std::vector<int>& prev_seats, const std::vector<int>& seats, std::vector<Paradox>& found) {
+
+    for (int i = 0; i < (int)states.size(); i++) {
+
+        if (seats[i] < prev_seats[i]) {
+
+            std::ostringstream witness;
+            witness << states[i] << " drops from " << prev_seats[i] << " to " << seats[i] << " seats going from K = " 
+                    << total_seats - 1 << " to " << total_seats;
+            found.push_back({method, "alabama", census, total_seats, witness.str()});
+
         }
     }
-    
-    std::vector<std::string> worst_subset; // reconstruct worst subset at the end
-    
-    for (int i = 0; i < n; i++) {
-        
-        if (worst_mask & (1LL << i)) 
-            worst_subset.push_back(states[i]);
-    
+}
+
+// state a grew at a higher rate than state b, yet a lost a seat while b gained one
+void check_population(const std::string& method, const std::string& census, int total_seats, const CensusPair& pair,
+                      const std::vector<int>& old_seats, const std::vector<int>& new_seats, std::vector<Paradox>& found) {
+
+    for (int a = 0; a < (int)pair.states.size(); a++) {
+
+        if (new_seats[a] >= old_seats[a])
+            continue;
+
+        for (int b = 0; b < (int)pair.states.size(); b++) {
+
+            if (new_seats[b] <= old_seats[b])
+                continue;
+
+            if (pair.new_pops[a] * pair.old_pops[b] <= pair.new_pops[b] * pair.old_pops[a]) // compare growth rates without dividing
+                continue;
+
+            std::ostringstream witness;
+            witness << pair.states[a] << " grew faster than " << pair.states[b] << " but went " << old_seats[a] << " -> " 
+                    << new_seats[a] << " while " << pair.states[b] << " went " << old_seats[b] << " -> " << new_seats[b];
+            found.push_back({method, "population", census, total_seats, witness.str()});
+
+        }
     }
-    
-    std::cout << "\n[APPROXIMATE] alpha >= " << min_alpha << " (based on " << num_samples << " samples)" << std::endl;
-    std::cout << "\nworst subset found (" << worst_subset.size() << " states):" << std::endl;
-    
-    for (const std::string& state : worst_subset) 
-        std::cout << "  " << state;
-    
-    std::cout << "\npopulation proportion: " << worst_pop_prop * 100 << "%" << std::endl;
-    std::cout << "seat proportion: " << worst_seat_prop * 100 << "%" << std::endl;
-    std::cout << "ratio (alpha): " << min_alpha << std::endl;
+}
 
-    return min_alpha;
+// scan every method over K = min_seats..max_seats for quota violations and the alabama paradox in both censuses,
+// and for the population paradox between them. work is split into (method, range of K) chunks across threads;
+// inside a chunk each K reuses the allocation for K - 1. returns false if the censuses share no states
+bool scan_paradoxes(const std::map<std::string, StateData>& old_map, const std::string& old_name,
+                    const std::map<std::string, StateData>& new_map, const std::string& new_name,
+                    int min_seats, int max_seats, std::vector<Paradox>& found) {
+
+    std::vector<std::string> methods = {"hamilton", "jefferson", "webster", "adams", "huntington_hill"};
+    int chunk_size = 250;
+
+    CensusPair pair = match_censuses(old_map, new_map);
+
+    if (pair.states.empty()) {
+
+        std::cerr << "error: no states in common between " << old_name << " and " << new_name << std::endl;
+        return false;
+
+    }
+
+    int n = pair.states.size();
+    std::string pair_name = old_name + " -> " + new_name;
+    bool one_census = (old_name == new_name); // scanning a single file, only report it once
+
+    struct Task {
+        std::string method;
+        int first;
+        int last;
+    };
+
+    std::vector<Task> tasks;
+
+    for (const std::string& method : methods) {
+
+        int first = std::max(min_seats, divisor_base_seats(method) * n); // adams and huntington-hill need a seat per state
+
+        for (int lo = first; lo <= max_seats; lo += chunk_size)
+            tasks.push_back({method, lo, std::min(lo + chunk_size - 1, max_seats)});
+
+    }
+
+    std::vector<std::vector<Paradox>> task_found(tasks.size());
+    std::atomic<int> next_task(0);
+    std::vector<std::thread> threads;
+    int num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "scanning " << methods.size() << " methods over K = " << min_seats << ".." << max_seats << " for " 
+              << n << " states in " << tasks.size() << " chunks on " << num_threads << " threads..." << std::endl;
+
+    for (int t = 0; t < num_threads; t++) {
+
+        threads.emplace_back([&]() {
+
+            for (int k = next_task++; k < (int)tasks.size(); k = next_task++) {
+
+                const Task& task = tasks[k];
+                std::vector<Paradox>& found = task_found[k];
+                int start = std::max(task.first - 1, divisor_base_seats(task.method) * n); // one below the chunk, for the alabama check
+
+                AllocationWalker old_walk(task.method, pair.old_pops, start);
+                AllocationWalker new_walk(task.method, pair.new_pops, start);
+
+                std::vector<int> old_prev = old_walk.get_seats();
+                std::vector<int> new_prev = new_walk.get_seats();
+
+                for (int total_seats = start; total_seats <= task.last; total_seats++) {
+
+                    if (total_seats > start) {
+
+                        old_walk.next();
+                        new_walk.next();
+
+                    }
+
+                    const std::vector<int>& old_seats = old_walk.get_seats();
+                    const std::vector<int>& new_seats = new_walk.get_seats();
+
+                    if (total_seats > start) {
+
+                        check_alabama(task.method, old_name, total_seats, pair.states, old_prev, old_seats, found);
+
+                        if (!one_census)
+                            check_alabama(task.method, new_name, total_seats, pair.states, new_prev, new_seats, found);
+
+                    }
+
+                    if (total_seats >= task.first) {
+
+                        check_quota(task.method, old_name, total_seats, pair.states, pair.old_pops, old_walk.get_total_pop(), old_seats, found);
+
+                        if (!one_census) {
+
+                            check_quota(task.method, new_name, total_seats, pair.states, pair.new_pops, new_walk.get_total_pop(), new_seats, found);
+                            check_population(task.method, pair_name, total_seats, pair, old_seats, new_seats, found);
+
+                        }
+
+                    }
+
+                    old_prev = old_seats;
+                    new_prev = new_seats;
+
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (const std::vector<Paradox>& chunk : task_found) // concatenate in task order so the output does not depend on scheduling
+        found.insert(found.end(), chunk.begin(), chunk.end());
+
+    return true;
 
 }
 
-int main() {
+void write_paradoxes(const std::vector<Paradox>& found, const std::string& filename) {
+
+    std::ofstream file(filename);
+
+    if (!file.is_open()) {
+
+        std::cerr << "error: could not open file " << filename << std::endl;
+        return;
+
+    }
+
+    file << "method,kind,census,house_size,witness\n";
+
+    for (const Paradox& p : found)
+        file << p.method << "," << p.kind << "," << p.census << "," << p.house_size << "," << p.witness << "\n";
+
+    file.close();
+
+}
+
+void print_paradox_summary(const std::vector<Paradox>& found) {
+
+    std::map<std::pair<std::string, std::string>, int> counts;
+    std::map<std::pair<std::string, std::string>, int> first_house;
+
+    for (const Paradox& p : found) {
+
+        auto key = std::make_pair(p.method, p.kind);
+
+        if (counts[key]++ == 0 || p.house_size < first_house[key])
+            first_house[key] = p.house_size;
+
+    }
+
+    std::cout << "\nmethod\t\tkind\t\tcount\tfirst K\n";
+    std::cout << "------\t\t----\t\t-----\t-------\n";
+
+    for (const auto& [key, count] : counts)
+        std::cout << key.first << "\t" << (key.first.size() < 8 ? "\t" : "") << key.second << "\t" 
+                  << (key.second.size() < 8 ? "\t" : "") << count << "\t" << first_house[key] << "\n";
+
+    std::cout << "\ntotal paradoxes: " << found.size() << "\n";
+
+}
+
+// parse a positive house size from the command line, false if (arg) is not one
+bool parse_seats(const std::string& arg, int& seats) {
+
+    size_t used = 0;
+
+    try {
+
+        seats = std::stoi(arg, &used);
+
+    } catch (const std::exception&) {
+
+        return false;
+
+    }
+
+    return used == arg.size() && seats > 0;
+
+}
+
+int main(int argc, char* argv[]) {
+
+    // ./238 scan [[old.csv new.csv] min_seats max_seats] -- look for quota violations and paradoxes instead of sampling alpha
+    if (argc > 1 && std::string(argv[1]) == "scan") {
+
+        std::string old_file = "state_populations_2020.csv";
+        std::string new_file = "state_populations.csv";
+        int min_seats = 50;
+        int max_seats = 10000;
+        int num_args = argc - 2;
+
+        if (num_args == 4) {
+
+            old_file = argv[2];
+            new_file = argv[3];
+
+        }
+
+        if ((num_args != 0 && num_args != 2 && num_args != 4)
+            || (num_args > 0 && !(parse_seats(argv[argc - 2], min_seats) && parse_seats(argv[argc - 1], max_seats)))
+            || min_seats > max_seats || max_seats > 1000000) { // keeps K + 1 and the chunk bounds well inside an int
+
+            std::cerr << "usage: " << argv[0] << " scan [[old.csv new.csv] min_seats max_seats], with 0 < min_seats <= max_seats <= 1000000" << std::endl;
+            return 1;
+
+        }
+
+        std::vector<Paradox> found;
+
+        if (!scan_paradoxes(read_state_data(old_file), old_file, read_state_data(new_file), new_file, min_seats, max_seats, found))
+            return 1;
+
+        write_paradoxes(found, "paradoxes.csv");
+        print_paradox_summary(found);
+
+        return 0;
+
+    }
     
     std::map<std::string, StateData> state_map = read_state_data("state_populations.csv");
     int total_seats = 435;
@@ -565,7 +1185,6 @@ int main() {
 
     */
 
-    float threshold = 0; // amount you want in the coalition
     std::vector<float> alphas_hamilton;
     std::vector<float> alphas_jefferson;
     std::vector<float> alphas_webster;
@@ -574,7 +1193,14 @@ int main() {
 
     for (int k = 0; k < 10; k++) {
 
-        threshold += 0.1;
+        float threshold = (k + 1) / 10.0f; // amount you want in the coalition, exactly 1 on the last pass
+
+        // sketches collect every sampled alpha over all runs at this threshold
+        AlphaSketch sketch_hamilton;
+        AlphaSketch sketch_jefferson;
+        AlphaSketch sketch_webster;
+        AlphaSketch sketch_adams;
+        AlphaSketch sketch_hh;
 
         for (int i = 0; i < 5; i++) {
 
@@ -592,35 +1218,35 @@ int main() {
 
             std::cout << "=== hamilton's method ===" << std::endl;
             hamiltons_method(state_map, total_seats);
-            curr = calculate_alpha_sampling(state_map, total_seats, threshold);
+            curr = calculate_alpha_sampling(state_map, total_seats, threshold, sketch_hamilton);
 
             min_hamilton_alpha = std::min(curr, min_hamilton_alpha);
             alphas_hamilton.push_back(min_hamilton_alpha);
             
             std::cout << "\n\n=== jefferson's method ===" << std::endl;
             jeffersons_method(state_map, total_seats);
-            curr = calculate_alpha_sampling(state_map, total_seats, threshold);
+            curr = calculate_alpha_sampling(state_map, total_seats, threshold, sketch_jefferson);
 
             min_jefferson_alpha = std::min(curr, min_jefferson_alpha);
             alphas_jefferson.push_back(min_jefferson_alpha);
             
             std::cout << "\n\n=== webster's method ===" << std::endl;
             websters_method(state_map, total_seats);
-            curr = calculate_alpha_sampling(state_map, total_seats, threshold);
+            curr = calculate_alpha_sampling(state_map, total_seats, threshold, sketch_webster);
 
             min_webster_alpha = std::min(curr, min_webster_alpha);
             alphas_webster.push_back(min_webster_alpha);
             
             std::cout << "\n\n=== adams' method ===" << std::endl;
             adams_method(state_map, total_seats);
-            curr = calculate_alpha_sampling(state_map, total_seats, threshold);
+            curr = calculate_alpha_sampling(state_map, total_seats, threshold, sketch_adams);
 
             min_adams_alpha = std::min(curr, min_adams_alpha);
             alphas_adams.push_back(min_adams_alpha);
             
             std::cout << "\n\n=== huntington-hill method ===" << std::endl;
             huntington_hill_method(state_map, total_seats);
-            curr = calculate_alpha_sampling(state_map, total_seats, threshold);
+            curr = calculate_alpha_sampling(state_map, total_seats, threshold, sketch_hh);
 
             min_hh_alpha = std::min(curr, min_hh_alpha);
             alphas_hh.push_back(min_hh_alpha);
@@ -630,6 +1256,15 @@ int main() {
 
         }
 
+        std::ostringstream suffix;
+        suffix << "_" << threshold << ".csv";
+
+        write_alpha_sketch(sketch_hamilton, state_map, "alpha_hamilton" + suffix.str());
+        write_alpha_sketch(sketch_jefferson, state_map, "alpha_jefferson" + suffix.str());
+        write_alpha_sketch(sketch_webster, state_map, "alpha_webster" + suffix.str());
+        write_alpha_sketch(sketch_adams, state_map, "alpha_adams" + suffix.str());
+        write_alpha_sketch(sketch_hh, state_map, "alpha_huntington_hill" + suffix.str());
+
     }
 
     std::cout << "=== hamilton alphas ===" << std::endl;